@@ -0,0 +1,203 @@
+// Board layout and the snapshot-able simulation state. Kept free of
+// renderer/audio calls so it can be exercised without a window.
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+
+#include <SDL2/SDL.h>
+#include <cstring>
+#include <type_traits>
+
+const int WINDOW_WIDTH = 500;
+const int WINDOW_HEIGHT = 700;
+const int COLUMN_WIDTH = 80;
+const int DOT_SIZE = 50;
+
+const int BUTTON_WIDTH = 120;
+const int BUTTON_HEIGHT = 80;
+const int BUTTON_Y = 600;
+
+enum Color { RED = 0, GREEN = 1, BLUE = 2 };
+
+// Kept trivially copyable (and padding-free) so it can live inside GameState
+struct Dot {
+  float x, y;
+  Color color;
+  float speed; // Individual speed (for difficulty variation)
+
+  Dot() = default;
+  Dot(float posX, float posY, Color c, float spd)
+      : x(posX), y(posY), color(c), speed(spd) {}
+
+  void move() { y += speed; }
+
+  bool reachedBottom() { return y > (BUTTON_Y - DOT_SIZE - 10); }
+};
+
+const int MAX_DOTS = 32;           // Far more than can fit in the column
+const int MAX_PATTERN_LENGTH = 16; // Cap for 3 + level / 3
+
+// Everything the simulation mutates, in one flat trivially-copyable block so a
+// snapshot is a single memcpy. Presentation-only state (particles, button
+// flashes, high score) deliberately stays outside.
+struct GameState {
+  Dot dots[MAX_DOTS];
+  int dotCount;
+  int frameCount;
+  int score;
+
+  int level;
+  float currentSpeed;
+  int currentSpawnInterval;
+  int lastLevelScore;
+  int levelUpTimer;
+
+  Color colorPattern[MAX_PATTERN_LENGTH];
+  int patternLength;
+  int patternIndex;
+
+  Uint32 rngState; // xorshift32, so rewinding replays the same spawns
+  bool showLevelUp;
+  bool usePattern;
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value,
+              "GameState must be memcpy-able");
+static_assert(sizeof(GameState) % sizeof(Uint32) == 0,
+              "GameState is diffed as 32-bit words");
+
+const int HISTORY_TICKS = 720;    // 12 seconds at 60 FPS
+const int KEYFRAME_INTERVAL = 30; // Full snapshot every half second
+const int KEYFRAME_SLOTS = 64;    // Room for regular + forced keyframes
+const int MAX_DELTA_WORDS = 16;   // More changes than this forces a keyframe
+const int STATE_WORDS = sizeof(GameState) / sizeof(Uint32);
+
+// Fixed-size ring of per-tick GameState snapshots. Most ticks only touch a few
+// words (dot positions, frame counter), so each tick stores the XOR of the
+// words that changed since the previous tick; a full keyframe is kept every
+// KEYFRAME_INTERVAL ticks (or whenever a delta would not fit). Restoring
+// copies the nearest keyframe and replays at most KEYFRAME_INTERVAL deltas.
+struct StateHistory {
+  GameState keyframes[KEYFRAME_SLOTS];
+  int keyframeTick[KEYFRAME_SLOTS];
+  int keyframeHead; // Next slot to write
+  int keyframeCount;
+
+  Uint16 deltaCount[HISTORY_TICKS];
+  Uint16 deltaIndex[HISTORY_TICKS][MAX_DELTA_WORDS];
+  Uint32 deltaValue[HISTORY_TICKS][MAX_DELTA_WORDS];
+
+  GameState last; // Most recent snapshot, used as the diff base
+  int newestTick;
+  int lastKeyframeTick;
+  int highWaterTick; // Highest tick ever written; rewinds never lower it
+
+  StateHistory() { clear(); }
+
+  void clear() {
+    keyframeHead = 0;
+    keyframeCount = 0;
+    newestTick = -1;
+    lastKeyframeTick = -1;
+    highWaterTick = -1;
+  }
+
+  bool empty() const { return newestTick < 0; }
+
+  void record(const GameState &current) {
+    int tick = ++newestTick;
+    int slot = tick % HISTORY_TICKS;
+    if (tick > highWaterTick)
+      highWaterTick = tick;
+
+    bool keyframe =
+        lastKeyframeTick < 0 || tick - lastKeyframeTick >= KEYFRAME_INTERVAL;
+
+    if (!keyframe) {
+      Uint32 before[STATE_WORDS], after[STATE_WORDS];
+      memcpy(before, &last, sizeof(GameState));
+      memcpy(after, &current, sizeof(GameState));
+
+      int changed = 0;
+      for (int w = 0; w < STATE_WORDS; w++) {
+        Uint32 diff = before[w] ^ after[w];
+        if (diff == 0)
+          continue;
+        if (changed == MAX_DELTA_WORDS) {
+          keyframe = true; // Too much changed; a keyframe is cheaper
+          break;
+        }
+        deltaIndex[slot][changed] = static_cast<Uint16>(w);
+        deltaValue[slot][changed] = diff;
+        changed++;
+      }
+      deltaCount[slot] = static_cast<Uint16>(changed);
+    }
+
+    if (keyframe) {
+      deltaCount[slot] = 0;
+      memcpy(&keyframes[keyframeHead], &current, sizeof(GameState));
+      keyframeTick[keyframeHead] = tick;
+      keyframeHead = (keyframeHead + 1) % KEYFRAME_SLOTS;
+      if (keyframeCount < KEYFRAME_SLOTS)
+        keyframeCount++;
+      lastKeyframeTick = tick;
+    }
+
+    memcpy(&last, &current, sizeof(GameState));
+  }
+
+  // Oldest tick that can still be rebuilt: its keyframe must be retained and
+  // every delta after it must not have been overwritten yet. A discarded
+  // future still overwrote delta slots, so the window is measured from the
+  // high-water tick rather than newestTick.
+  int oldestTick() const {
+    int limit = highWaterTick - HISTORY_TICKS + 1;
+    int oldest = newestTick;
+    // Live keyframes are the keyframeCount slots just behind keyframeHead
+    for (int k = 1; k <= keyframeCount; k++) {
+      int slot = (keyframeHead + KEYFRAME_SLOTS - k) % KEYFRAME_SLOTS;
+      int t = keyframeTick[slot];
+      if (t < limit)
+        break; // Older ones are out of the window too
+      oldest = t;
+    }
+    return oldest;
+  }
+
+  // Rebuilds the snapshot for `tick` (clamped to what is still available)
+  // into `out` and discards everything newer. Returns the tick restored.
+  int rewindTo(int tick, GameState &out) {
+    if (tick < oldestTick())
+      tick = oldestTick();
+    if (tick > newestTick)
+      tick = newestTick;
+
+    // Drop keyframes from the discarded future
+    while (keyframeCount > 0) {
+      int prev = (keyframeHead + KEYFRAME_SLOTS - 1) % KEYFRAME_SLOTS;
+      if (keyframeTick[prev] <= tick)
+        break;
+      keyframeHead = prev;
+      keyframeCount--;
+    }
+
+    int base = (keyframeHead + KEYFRAME_SLOTS - 1) % KEYFRAME_SLOTS;
+    Uint32 words[STATE_WORDS];
+    memcpy(words, &keyframes[base], sizeof(GameState));
+
+    for (int t = keyframeTick[base] + 1; t <= tick; t++) {
+      int slot = t % HISTORY_TICKS;
+      for (int d = 0; d < deltaCount[slot]; d++) {
+        words[deltaIndex[slot][d]] ^= deltaValue[slot][d];
+      }
+    }
+
+    memcpy(&out, words, sizeof(GameState));
+    memcpy(&last, words, sizeof(GameState));
+    newestTick = tick;
+    lastKeyframeTick = keyframeTick[base];
+    return tick;
+  }
+};
+
+#endif // GAME_STATE_H
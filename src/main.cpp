@@ -3,39 +3,219 @@
 #include <SDL2/SDL_mixer.h>
 #include <SDL2/SDL_ttf.h>
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <iostream>
 #include <string>
 #include <vector>
 
-const int WINDOW_WIDTH = 500;
-const int WINDOW_HEIGHT = 700;
-const int COLUMN_WIDTH = 80;
-const int DOT_SIZE = 50;
+#include "game_state.h"
 
 const float SPEED_INCREASE_RATE = 0.1f; // Speed increase per level
 const int SPAWN_DECREASE_RATE = 5;      // Spawn interval decrease per level
 const int POINTS_PER_LEVEL = 100;       // Points needed for next level
+const int REWIND_TICKS = 180;           // Practice mode jumps back 3 seconds
+
+const int MAX_PARTICLES = 8192;       // Pool capacity (never reallocated)
+const float PARTICLE_GRAVITY = 0.15f; // Downward pull per frame
+const float PARTICLE_SIZE = 4.0f;     // Quad edge length in pixels
+
+// Structure-of-arrays particle pool. All storage is allocated once up front;
+// spawning and killing only move the live count, so bursts never allocate.
+// Live particles are always packed into [0, count) so the update loop and the
+// vertex build walk contiguous memory.
+struct ParticleSystem {
+  int count;
+  std::vector<float> x, y, vx, vy;
+  std::vector<float> life, fade; // fade = 1 / initial life
+  std::vector<Uint8> r, g, b;
+
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+
+  ParticleSystem()
+      : count(0), x(MAX_PARTICLES), y(MAX_PARTICLES), vx(MAX_PARTICLES),
+        vy(MAX_PARTICLES), life(MAX_PARTICLES), fade(MAX_PARTICLES),
+        r(MAX_PARTICLES), g(MAX_PARTICLES), b(MAX_PARTICLES),
+        vertices(MAX_PARTICLES * 4), indices(MAX_PARTICLES * 6) {
+    // Two triangles per quad; the index pattern never changes
+    for (int i = 0; i < MAX_PARTICLES; i++) {
+      int v = i * 4;
+      int *idx = &indices[i * 6];
+      idx[0] = v;
+      idx[1] = v + 1;
+      idx[2] = v + 2;
+      idx[3] = v + 2;
+      idx[4] = v + 3;
+      idx[5] = v;
+    }
+    for (auto &vert : vertices) {
+      vert.tex_coord = {0.0f, 0.0f};
+    }
+  }
+
+  void burst(float cx, float cy, SDL_Color color, int amount, float power,
+             int lifetime) {
+    if (amount > MAX_PARTICLES - count)
+      amount = MAX_PARTICLES - count; // Drop what doesn't fit
+
+    for (int n = 0; n < amount; n++) {
+      int i = count++;
+      float angle = (rand() % 628) * 0.01f;
+      float strength = power * (0.3f + (rand() % 70) * 0.01f);
+      float ticks = lifetime * (0.6f + (rand() % 40) * 0.01f);
+
+      x[i] = cx;
+      y[i] = cy;
+      vx[i] = cos(angle) * strength;
+      vy[i] = sin(angle) * strength - power * 0.5f;
+      life[i] = ticks;
+      fade[i] = 1.0f / ticks;
+      r[i] = color.r;
+      g[i] = color.g;
+      b[i] = color.b;
+    }
+  }
+
+  void update() {
+    float *px = x.data(), *py = y.data();
+    float *pvx = vx.data(), *pvy = vy.data();
+    float *plife = life.data();
+
+    // Branch-free integration over the packed range
+    for (int i = 0; i < count; i++) {
+      pvy[i] += PARTICLE_GRAVITY;
+      px[i] += pvx[i];
+      py[i] += pvy[i];
+      plife[i] -= 1.0f;
+    }
+
+    // Swap-remove dead particles to keep the live range packed
+    for (int i = count - 1; i >= 0; i--) {
+      if (plife[i] <= 0.0f) {
+        int last = --count;
+        x[i] = x[last];
+        y[i] = y[last];
+        vx[i] = vx[last];
+        vy[i] = vy[last];
+        life[i] = life[last];
+        fade[i] = fade[last];
+        r[i] = r[last];
+        g[i] = g[last];
+        b[i] = b[last];
+      }
+    }
+  }
+
+  void clear() { count = 0; }
 
-const int BUTTON_WIDTH = 120;
-const int BUTTON_HEIGHT = 80;
-const int BUTTON_Y = 600;
+  // Draws every live particle with a single SDL_RenderGeometry call
+  void draw(SDL_Renderer *renderer) {
+    if (count == 0)
+      return;
+
+    const float half = PARTICLE_SIZE * 0.5f;
+    for (int i = 0; i < count; i++) {
+      SDL_Color c = {r[i], g[i], b[i],
+                     static_cast<Uint8>(255.0f * life[i] * fade[i])};
+      SDL_Vertex *v = &vertices[i * 4];
+      v[0].position = {x[i] - half, y[i] - half};
+      v[1].position = {x[i] + half, y[i] - half};
+      v[2].position = {x[i] + half, y[i] + half};
+      v[3].position = {x[i] - half, y[i] + half};
+      v[0].color = v[1].color = v[2].color = v[3].color = c;
+    }
 
-enum Color { RED = 0, GREEN = 1, BLUE = 2 };
+    SDL_BlendMode previous;
+    SDL_GetRenderDrawBlendMode(renderer, &previous);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_ADD);
+    SDL_RenderGeometry(renderer, nullptr, vertices.data(), count * 4,
+                       indices.data(), count * 6);
+    SDL_SetRenderDrawBlendMode(renderer, previous);
+  }
+};
+
+// Optional visual work is shed from the top down when frames run long.
+// MEDIUM drops the dot pulse/double border, tutorial hints and the blended
+// overlays/banner fade (back to the original opaque drawing) and halves
+// particle bursts; LOW quarters particle bursts.
+enum Quality { QUALITY_LOW = 0, QUALITY_MEDIUM = 1, QUALITY_HIGH = 2 };
+
+const float QUALITY_DOWN_LOAD = 0.85f;   // Step down above this budget share
+const float QUALITY_UP_LOAD = 0.5f;      // Step up only below this budget share
+const float QUALITY_MISS_FACTOR = 1.25f; // Longer frame intervals are misses
+const int QUALITY_DOWN_FRAMES = 30;      // Half a second over budget
+const int QUALITY_UP_FRAMES = 300;       // Five seconds of steady headroom
+
+const char *qualityName(Quality q) {
+  switch (q) {
+  case QUALITY_LOW:
+    return "LOW";
+  case QUALITY_MEDIUM:
+    return "MEDIUM";
+  case QUALITY_HIGH:
+  default:
+    return "HIGH";
+  }
+}
 
-struct Dot {
-  float x, y;
-  Color color;
-  bool active;
-  float speed; // Individual speed (for difficulty variation)
+// Picks a quality level from two measurements: CPU frame cost (events,
+// update, render and a flush of the batched draw calls, excluding Present and
+// the frame-cap sleep) and the real interval between frame starts. GPU fill
+// cost only shows up as Present blocking longer, so a frame whose interval
+// overruns the budget counts as slow even when its CPU cost looks fine; a
+// vsync-locked frame lands on the refresh and is not counted. Stepping down
+// needs a short run of slow frames, stepping up a much longer run of fast
+// ones, so a machine near the threshold does not flicker between levels.
+struct QualityGovernor {
+  Quality quality;
+  bool pinned;
+  float averageMs;
+  int slowFrames;
+  int fastFrames;
+
+  QualityGovernor()
+      : quality(QUALITY_HIGH), pinned(false), averageMs(0.0f), slowFrames(0),
+        fastFrames(0) {}
+
+  void pin(Quality q) {
+    quality = q;
+    pinned = true;
+  }
 
-  Dot(float posX, float posY, Color c, float spd)
-      : x(posX), y(posY), color(c), active(true), speed(spd) {}
+  // Returns true when the quality level changed
+  bool update(float workMs, float intervalMs, float budgetMs) {
+    averageMs += (workMs - averageMs) * 0.1f; // Smooth out single spikes
+    if (pinned)
+      return false;
 
-  void move() { y += speed; }
+    float load = averageMs / budgetMs;
+    bool missed = intervalMs > budgetMs * QUALITY_MISS_FACTOR;
+    if (load > QUALITY_DOWN_LOAD || missed) {
+      slowFrames++;
+      fastFrames = 0;
+    } else if (load < QUALITY_UP_LOAD) {
+      fastFrames++;
+      slowFrames = 0;
+    } else {
+      slowFrames = 0;
+      fastFrames = 0;
+    }
 
-  bool reachedBottom() { return y > (BUTTON_Y - DOT_SIZE - 10); }
+    if (slowFrames >= QUALITY_DOWN_FRAMES && quality > QUALITY_LOW) {
+      quality = static_cast<Quality>(quality - 1);
+      slowFrames = 0;
+      return true;
+    }
+    if (fastFrames >= QUALITY_UP_FRAMES && quality < QUALITY_HIGH) {
+      quality = static_cast<Quality>(quality + 1);
+      fastFrames = 0;
+      return true;
+    }
+    return false;
+  }
 };
 
 class Game {
@@ -53,71 +233,112 @@ private:
   Mix_Chunk *missSound;
   Mix_Chunk *levelUpSound;
 
-  std::vector<Dot> dots;
-  int frameCount;
-  int score;
+  GameState state;
   int highScore;
   bool gameOver;
   bool paused;
 
-  int level;
-  float currentSpeed;
-  int currentSpawnInterval;
-  int lastLevelScore;
-  bool showLevelUp;
-  int levelUpTimer;
-
-  std::vector<Color> colorPattern;
-  int patternIndex;
-  bool usePattern;
+  bool practiceMode; // Rewind on mistakes instead of ending the game
+  StateHistory history;
+  int rewindTimer;
 
   bool buttonPressed[3] = {false, false, false};
   int buttonPressTimer[3] = {0, 0, 0};
 
-  Color getRandomColor() { return static_cast<Color>(rand() % 3); }
+  ParticleSystem particles;
+  QualityGovernor governor;
+
+  // Scales a particle burst down to what the current quality level affords
+  int particleAmount(int amount) {
+    return amount >> (QUALITY_HIGH - governor.quality);
+  }
+
+  // Full-screen dimming. Blending costs a full-screen fill on top of the
+  // opaque drawing the game always had, so only HIGH pays for it
+  void drawOverlay(Uint8 alpha) {
+    SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+    if (governor.quality < QUALITY_HIGH) {
+      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+      SDL_RenderFillRect(renderer, &overlay);
+      return;
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, alpha);
+    SDL_RenderFillRect(renderer, &overlay);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+  }
+
+  SDL_Color getDotColor(Color c) {
+    switch (c) {
+    case RED:
+      return {255, 50, 50, 255};
+    case GREEN:
+      return {50, 255, 50, 255};
+    case BLUE:
+    default:
+      return {50, 100, 255, 255};
+    }
+  }
+
+  // xorshift32 over GameState::rngState; gameplay randomness must come from
+  // here (not rand()) so a restored snapshot replays identically
+  int nextRandom() {
+    Uint32 x = state.rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state.rngState = x;
+    return static_cast<int>(x & 0x7fffffff);
+  }
+
+  Color getRandomColor() { return static_cast<Color>(nextRandom() % 3); }
 
   void generatePattern() {
-    colorPattern.clear();
-    patternIndex = 0;
+    state.patternIndex = 0;
 
-    int patternLength = 3 + (level / 3); // Longer patterns at higher levels
+    // Longer patterns at higher levels
+    int patternLength = 3 + (state.level / 3);
+    if (patternLength > MAX_PATTERN_LENGTH)
+      patternLength = MAX_PATTERN_LENGTH;
+    state.patternLength = patternLength;
 
-    if (level < 3) {
+    if (state.level < 3) {
       for (int i = 0; i < patternLength; i++) {
-        colorPattern.push_back(getRandomColor());
+        state.colorPattern[i] = getRandomColor();
       }
-    } else if (level < 6) {
+    } else if (state.level < 6) {
       Color first = getRandomColor();
       Color second = getRandomColor();
       for (int i = 0; i < patternLength; i++) {
-        colorPattern.push_back(i % 2 == 0 ? first : second);
+        state.colorPattern[i] = (i % 2 == 0 ? first : second);
       }
     } else {
       for (int i = 0; i < patternLength; i++) {
         if (i % 3 == 0)
-          colorPattern.push_back(RED);
+          state.colorPattern[i] = RED;
         else if (i % 3 == 1)
-          colorPattern.push_back(GREEN);
+          state.colorPattern[i] = GREEN;
         else
-          colorPattern.push_back(BLUE);
+          state.colorPattern[i] = BLUE;
       }
-      if (rand() % 2 == 0) {
-        std::reverse(colorPattern.begin(), colorPattern.end());
+      if (nextRandom() % 2 == 0) {
+        std::reverse(state.colorPattern, state.colorPattern + patternLength);
       }
     }
 
-    usePattern =
-        (level >= 2 &&
-         rand() % 100 < 30 + level * 5); // Increase pattern probability
+    // Increase pattern probability
+    state.usePattern =
+        (state.level >= 2 && nextRandom() % 100 < 30 + state.level * 5);
   }
 
   Color getNextColor() {
-    if (usePattern && !colorPattern.empty()) {
-      Color c = colorPattern[patternIndex];
-      patternIndex++;
-      if (patternIndex >= colorPattern.size()) {
-        patternIndex = 0;
-        if (rand() % 100 < 40) {
+    if (state.usePattern && state.patternLength > 0) {
+      Color c = state.colorPattern[state.patternIndex];
+      state.patternIndex++;
+      if (state.patternIndex >= state.patternLength) {
+        state.patternIndex = 0;
+        if (nextRandom() % 100 < 40) {
           generatePattern();
         }
       }
@@ -126,38 +347,67 @@ private:
     return getRandomColor();
   }
 
+  void resetState() {
+    memset(&state, 0, sizeof(state)); // Also zeroes padding for stable diffs
+    state.level = 1;
+    state.currentSpeed = 2.0f;
+    state.currentSpawnInterval = 120;
+    state.rngState = static_cast<Uint32>(time(nullptr)) | 1; // Never zero
+    history.clear();
+  }
+
+  // Practice mode: restore the snapshot from a few seconds ago instead of
+  // ending the game. Returns false when there is nothing to rewind to.
+  bool rewindAfterMistake() {
+    if (!practiceMode || history.empty())
+      return false;
+
+    int tick = history.rewindTo(history.newestTick - REWIND_TICKS, state);
+    rewindTimer = 60;
+    std::cout << "⏪ Rewound to tick " << tick << " (Score: " << state.score
+              << ")" << std::endl;
+    return true;
+  }
+
   void updateDifficulty() {
-    int newLevel = 1 + (score / POINTS_PER_LEVEL);
+    int newLevel = 1 + (state.score / POINTS_PER_LEVEL);
 
-    if (newLevel > level) {
-      level = newLevel;
-      lastLevelScore = score;
+    if (newLevel > state.level) {
+      state.level = newLevel;
+      state.lastLevelScore = state.score;
 
-      currentSpeed = 2.0f + (level - 1) * SPEED_INCREASE_RATE;
+      state.currentSpeed = 2.0f + (state.level - 1) * SPEED_INCREASE_RATE;
 
-      currentSpawnInterval = 120 - (level - 1) * SPAWN_DECREASE_RATE;
-      if (currentSpawnInterval < 40)
-        currentSpawnInterval = 40; // Minimum limit
+      state.currentSpawnInterval =
+          120 - (state.level - 1) * SPAWN_DECREASE_RATE;
+      if (state.currentSpawnInterval < 40)
+        state.currentSpawnInterval = 40; // Minimum limit
 
-      showLevelUp = true;
-      levelUpTimer = 120; // Show for 2 seconds
+      state.showLevelUp = true;
+      state.levelUpTimer = 120; // Show for 2 seconds
 
       if (levelUpSound) {
         Mix_PlayChannel(-1, levelUpSound, 0);
       }
 
+      // Bigger celebration at higher levels
+      particles.burst(WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2, {255, 215, 0, 255},
+                      particleAmount(300 + state.level * 100), 6.0f, 90);
+
       generatePattern();
 
-      std::cout << "🎉 LEVEL UP! Now Level " << level << std::endl;
-      std::cout << "   Speed: " << currentSpeed
-                << " | Spawn Rate: " << currentSpawnInterval << std::endl;
+      std::cout << "🎉 LEVEL UP! Now Level " << state.level << std::endl;
+      std::cout << "   Speed: " << state.currentSpeed
+                << " | Spawn Rate: " << state.currentSpawnInterval << std::endl;
     }
   }
 
   void drawDot(const Dot &dot) {
+    bool detailed = governor.quality == QUALITY_HIGH;
+
     int alpha = 255;
-    if (dot.speed > 3.0f) {
-      alpha = 200 + (int)(55 * sin(frameCount * 0.1f));
+    if (detailed && dot.speed > 3.0f) {
+      alpha = 200 + (int)(55 * sin(state.frameCount * 0.1f));
     }
 
     switch (dot.color) {
@@ -177,7 +427,7 @@ private:
     SDL_RenderFillRect(renderer, &rect);
 
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    if (dot.speed > 3.5f) {
+    if (detailed && dot.speed > 3.5f) {
       SDL_RenderDrawRect(renderer, &rect);
       SDL_Rect innerRect = {rect.x + 2, rect.y + 2, rect.w - 4, rect.h - 4};
       SDL_RenderDrawRect(renderer, &innerRect);
@@ -187,7 +437,7 @@ private:
   }
 
   void drawColumn() {
-    int intensity = 80 + (level * 5);
+    int intensity = 80 + (state.level * 5);
     if (intensity > 120)
       intensity = 120;
 
@@ -196,8 +446,8 @@ private:
                        BUTTON_Y};
     SDL_RenderFillRect(renderer, &column);
 
-    SDL_SetRenderDrawColor(renderer, 150 + level * 5, 150 + level * 5,
-                           160 + level * 5, 255);
+    SDL_SetRenderDrawColor(renderer, 150 + state.level * 5,
+                           150 + state.level * 5, 160 + state.level * 5, 255);
     SDL_RenderDrawRect(renderer, &column);
   }
 
@@ -261,28 +511,27 @@ private:
   void drawUI() {
     renderText("RGB GUARDIAN", 10, 10, titleFont, {255, 255, 100, 255});
 
-    renderText("Score: " + std::to_string(score), 10, 50, font);
+    renderText("Score: " + std::to_string(state.score), 10, 50, font);
 
     renderText("Best: " + std::to_string(highScore), 10, 75, font);
 
     SDL_Color levelColor = {100, 255, 255, 255};
-    if (level > 5)
+    if (state.level > 5)
       levelColor = {255, 150, 50, 255}; // Orange for high levels
-    if (level > 10)
+    if (state.level > 10)
       levelColor = {255, 50, 50, 255}; // Red for very high levels
 
-    renderText("Level: " + std::to_string(level), 10, 100, font, levelColor);
+    renderText("Level: " + std::to_string(state.level), 10, 100, font,
+               levelColor);
 
     if (smallFont) {
       std::string speedText =
-          "Speed: x" + std::to_string(currentSpeed).substr(0, 3);
+          "Speed: x" + std::to_string(state.currentSpeed).substr(0, 3);
       renderText(speedText, 10, 125, smallFont, {200, 200, 200, 255});
     }
 
     if (paused) {
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
-      SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-      SDL_RenderFillRect(renderer, &overlay);
+      drawOverlay(180);
 
       SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
       SDL_Rect pauseBox = {WINDOW_WIDTH / 2 - 120, WINDOW_HEIGHT / 2 - 80, 240,
@@ -307,16 +556,23 @@ private:
       return; // Don't draw other UI elements when paused
     }
 
-    if (showLevelUp && levelUpTimer > 0) {
-      int alpha = (levelUpTimer > 60) ? 255 : (levelUpTimer * 4);
+    if (state.showLevelUp && state.levelUpTimer > 0) {
+      bool fade = governor.quality == QUALITY_HIGH;
+      int alpha = 255;
+      if (fade && state.levelUpTimer <= 60)
+        alpha = state.levelUpTimer * 4;
+      if (fade)
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
       SDL_SetRenderDrawColor(renderer, 255, 215, 0, alpha * 0.8);
       SDL_Rect banner = {50, WINDOW_HEIGHT / 2 - 40, WINDOW_WIDTH - 100, 80};
       SDL_RenderFillRect(renderer, &banner);
 
       SDL_SetRenderDrawColor(renderer, 255, 255, 255, alpha);
       SDL_RenderDrawRect(renderer, &banner);
+      SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 
-      std::string levelText = "LEVEL " + std::to_string(level) + "!";
+      std::string levelText = "LEVEL " + std::to_string(state.level) + "!";
       renderText(levelText, WINDOW_WIDTH / 2 - 60, WINDOW_HEIGHT / 2 - 20,
                  titleFont, {255, 255, 255, static_cast<Uint8>(alpha)});
 
@@ -326,24 +582,33 @@ private:
                    {255, 255, 255, static_cast<Uint8>(alpha)});
       }
 
-      levelUpTimer--;
-      if (levelUpTimer == 0) {
-        showLevelUp = false;
+      state.levelUpTimer--;
+      if (state.levelUpTimer == 0) {
+        state.showLevelUp = false;
       }
     }
 
-    if (frameCount < 300 && !gameOver && level == 1) {
+    if (rewindTimer > 0) {
+      renderText("REWIND!", WINDOW_WIDTH / 2 - 55, 160, titleFont,
+                 {150, 200, 255, 255});
+    }
+
+    // Hints rasterize new text every frame; first to go when frames run long
+    if (governor.quality < QUALITY_HIGH)
+      return;
+
+    if (state.frameCount < 300 && !gameOver && state.level == 1) {
       renderText("Press R, G, or B keys!", WINDOW_WIDTH / 2 - 100,
                  BUTTON_Y - 40, font, {200, 200, 255, 255});
     }
 
-    if (frameCount > 60 && frameCount < 240 && !gameOver && !paused &&
-        smallFont) {
+    if (state.frameCount > 60 && state.frameCount < 240 && !gameOver &&
+        !paused && smallFont) {
       renderText("Press P to pause", WINDOW_WIDTH - 140, 10, smallFont,
                  {150, 150, 200, 200});
     }
 
-    if (usePattern && level >= 3 && smallFont) {
+    if (state.usePattern && state.level >= 3 && smallFont) {
       renderText("Pattern Mode!", WINDOW_WIDTH / 2 - 50, BUTTON_Y - 40,
                  smallFont, {255, 200, 100, 255});
     }
@@ -356,29 +621,39 @@ private:
     buttonPressed[pressedColor] = true;
     buttonPressTimer[pressedColor] = 10;
 
-    Dot *targetDot = nullptr;
+    int targetIndex = -1;
     float lowestY = -1;
 
-    for (auto &dot : dots) {
-      if (dot.active && dot.y > lowestY) {
-        lowestY = dot.y;
-        targetDot = &dot;
+    for (int i = 0; i < state.dotCount; i++) {
+      if (state.dots[i].y > lowestY) {
+        lowestY = state.dots[i].y;
+        targetIndex = i;
       }
     }
 
-    if (targetDot != nullptr) {
-      if (targetDot->color == pressedColor) {
-        targetDot->active = false;
+    if (targetIndex >= 0) {
+      if (state.dots[targetIndex].color == pressedColor) {
+        // Swap-remove (copied first, since the slot is overwritten): only the
+        // cleared slot and the count change, which keeps the history delta
+        // small
+        const Dot cleared = state.dots[targetIndex];
+        state.dotCount--;
+        state.dots[targetIndex] = state.dots[state.dotCount];
 
         int points = 10;
-        if (targetDot->speed > 3.5f)
+        if (cleared.speed > 3.5f)
           points = 20;
-        else if (targetDot->speed > 2.5f)
+        else if (cleared.speed > 2.5f)
           points = 15;
 
-        score += points;
-        if (score > highScore)
-          highScore = score;
+        state.score += points;
+        if (state.score > highScore)
+          highScore = state.score;
+
+        particles.burst(cleared.x + DOT_SIZE / 2, cleared.y + DOT_SIZE / 2,
+                        getDotColor(cleared.color),
+                        particleAmount(40 + state.level * 20),
+                        3.0f + state.level * 0.2f, 45);
 
         Mix_PlayChannel(-1, correctSound, 0);
 
@@ -386,13 +661,15 @@ private:
           std::cout << "✓ Perfect! +" << points << " points (Fast dot bonus!)"
                     << std::endl;
         } else {
-          std::cout << "✓ Correct! Score: " << score << std::endl;
+          std::cout << "✓ Correct! Score: " << state.score << std::endl;
         }
 
         updateDifficulty();
       } else {
         Mix_PlayChannel(-1, wrongSound, 0);
-        std::cout << "✗ Wrong color! Game Over! Final Level: " << level
+        if (rewindAfterMistake())
+          return;
+        std::cout << "✗ Wrong color! Game Over! Final Level: " << state.level
                   << std::endl;
         gameOver = true;
         Mix_HaltMusic();
@@ -401,15 +678,16 @@ private:
   }
 
 public:
-  Game()
+  Game(bool practice = false, int pinnedQuality = -1)
       : window(nullptr), renderer(nullptr), font(nullptr), titleFont(nullptr),
         smallFont(nullptr), bgMusic(nullptr), correctSound(nullptr),
         wrongSound(nullptr), missSound(nullptr), levelUpSound(nullptr),
-        running(true), frameCount(0), score(0), highScore(0), gameOver(false),
-        paused(false), level(1), currentSpeed(2.0f), currentSpawnInterval(120),
-        lastLevelScore(0), showLevelUp(false), levelUpTimer(0), patternIndex(0),
-        usePattern(false) {
+        running(true), highScore(0), gameOver(false), paused(false),
+        practiceMode(practice), rewindTimer(0) {
     srand(static_cast<unsigned>(time(nullptr)));
+    resetState();
+    if (pinnedQuality >= QUALITY_LOW && pinnedQuality <= QUALITY_HIGH)
+      governor.pin(static_cast<Quality>(pinnedQuality));
   }
 
   bool init() {
@@ -469,6 +747,11 @@ public:
     std::cout << "  G = Green" << std::endl;
     std::cout << "  B = Blue" << std::endl;
     std::cout << "  P = Pause/Resume" << std::endl;
+    if (practiceMode)
+      std::cout << "  Practice mode: mistakes rewind 3 seconds" << std::endl;
+    if (governor.pinned)
+      std::cout << "  Quality pinned to " << qualityName(governor.quality)
+                << std::endl;
     std::cout << "  ESC = Exit" << std::endl;
     std::cout << "\nDifficulty System:" << std::endl;
     std::cout << "  - Every " << POINTS_PER_LEVEL << " points = Level Up!"
@@ -536,14 +819,8 @@ public:
           if (gameOver) {
             gameOver = false;
             paused = false;
-            score = 0;
-            level = 1;
-            currentSpeed = 2.0f;
-            currentSpawnInterval = 120;
-            dots.clear();
-            frameCount = 0;
-            showLevelUp = false;
-            usePattern = false;
+            resetState();
+            particles.clear();
             if (bgMusic)
               Mix_PlayMusic(bgMusic, -1);
             std::cout << "\n=== NEW GAME ===" << std::endl;
@@ -564,45 +841,61 @@ public:
       }
     }
 
+    if (rewindTimer > 0)
+      rewindTimer--;
+
+    // Particles keep animating on the game over screen so the miss burst plays
+    if (!paused)
+      particles.update();
+
     if (gameOver || paused)
       return;
 
-    frameCount++;
+    state.frameCount++;
 
-    if (frameCount % currentSpawnInterval == 0) {
+    if (state.frameCount % state.currentSpawnInterval == 0) {
       float x = WINDOW_WIDTH / 2 - DOT_SIZE / 2;
       Color c = getNextColor();
 
-      float speedVariation = (level > 3) ? (rand() % 10) * 0.1f : 0.0f;
-      float dotSpeed = currentSpeed + speedVariation;
+      float speedVariation =
+          (state.level > 3) ? (nextRandom() % 10) * 0.1f : 0.0f;
+      float dotSpeed = state.currentSpeed + speedVariation;
 
-      dots.push_back(Dot(x, -DOT_SIZE, c, dotSpeed));
+      if (state.dotCount < MAX_DOTS) {
+        state.dots[state.dotCount++] = Dot(x, -DOT_SIZE, c, dotSpeed);
+      }
     }
 
-    for (auto &dot : dots) {
-      if (dot.active) {
-        dot.move();
+    bool missed = false;
+    for (int i = 0; i < state.dotCount; i++) {
+      Dot &dot = state.dots[i];
+      dot.move();
 
-        if (dot.reachedBottom()) {
-          std::cout << "✗ Missed a dot! Game Over! Final Level: " << level
-                    << std::endl;
-          gameOver = true;
-          Mix_HaltMusic();
-          if (missSound)
-            Mix_PlayChannel(-1, missSound, 0);
-        }
+      if (dot.reachedBottom() && !missed) {
+        missed = true;
+        if (missSound)
+          Mix_PlayChannel(-1, missSound, 0);
+
+        particles.burst(dot.x + DOT_SIZE / 2, dot.y + DOT_SIZE / 2,
+                        {255, 60, 60, 255}, particleAmount(400), 5.0f, 70);
       }
     }
 
-    dots.erase(std::remove_if(dots.begin(), dots.end(),
-                              [](const Dot &d) {
-                                return !d.active && d.y > WINDOW_HEIGHT;
-                              }),
-               dots.end());
+    if (missed) {
+      if (rewindAfterMistake())
+        return;
+      std::cout << "✗ Missed a dot! Game Over! Final Level: " << state.level
+                << std::endl;
+      gameOver = true;
+      Mix_HaltMusic();
+      return;
+    }
+
+    history.record(state);
   }
 
   void render() {
-    int bgDarkness = 25 - (level * 2);
+    int bgDarkness = 25 - (state.level * 2);
     if (bgDarkness < 10)
       bgDarkness = 10;
     SDL_SetRenderDrawColor(renderer, bgDarkness, bgDarkness, bgDarkness + 10,
@@ -611,26 +904,25 @@ public:
 
     drawColumn();
 
-    for (const auto &dot : dots) {
-      if (dot.active) {
-        drawDot(dot);
-      }
+    for (int i = 0; i < state.dotCount; i++) {
+      drawDot(state.dots[i]);
     }
 
+    particles.draw(renderer);
+
     drawButtons();
 
     drawUI();
 
     if (gameOver) {
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
-      SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-      SDL_RenderFillRect(renderer, &overlay);
+      drawOverlay(200);
 
       renderText("GAME OVER", WINDOW_WIDTH / 2 - 80, WINDOW_HEIGHT / 2 - 80,
                  titleFont, {255, 100, 100, 255});
-      renderText("Final Score: " + std::to_string(score), WINDOW_WIDTH / 2 - 70,
-                 WINDOW_HEIGHT / 2 - 30, font, {255, 255, 255, 255});
-      renderText("Level Reached: " + std::to_string(level),
+      renderText("Final Score: " + std::to_string(state.score),
+                 WINDOW_WIDTH / 2 - 70, WINDOW_HEIGHT / 2 - 30, font,
+                 {255, 255, 255, 255});
+      renderText("Level Reached: " + std::to_string(state.level),
                  WINDOW_WIDTH / 2 - 75, WINDOW_HEIGHT / 2, font,
                  {255, 255, 100, 255});
       renderText("Best Score: " + std::to_string(highScore),
@@ -639,8 +931,6 @@ public:
       renderText("Press SPACE to restart", WINDOW_WIDTH / 2 - 100,
                  WINDOW_HEIGHT / 2 + 60, font, {200, 200, 255, 255});
     }
-
-    SDL_RenderPresent(renderer);
   }
 
   void run() {
@@ -648,16 +938,38 @@ public:
 
     const int FPS = 60;
     const int frameDelay = 1000 / FPS;
+    const float frameBudgetMs = 1000.0f / FPS;
 
     Uint32 frameStart;
     int frameTime;
 
+    const float ticksToMs = 1000.0f / SDL_GetPerformanceFrequency();
+    Uint64 lastWorkStart = 0;
+
     while (running) {
       frameStart = SDL_GetTicks();
+      Uint64 workStart = SDL_GetPerformanceCounter();
+
+      // Real length of the previous frame, Present and sleep included
+      float intervalMs =
+          lastWorkStart ? (workStart - lastWorkStart) * ticksToMs : 0.0f;
+      lastWorkStart = workStart;
 
       handleEvents();
       update();
       render();
+      SDL_RenderFlush(renderer); // Submit batched draws inside the timed span
+
+      // Stop timing before Present: with forced vsync it blocks until the
+      // next refresh, which would read as a permanently full budget
+      float workMs = (SDL_GetPerformanceCounter() - workStart) * ticksToMs;
+      SDL_RenderPresent(renderer);
+
+      if (governor.update(workMs, intervalMs, frameBudgetMs)) {
+        std::cout << "⚙️  Quality set to " << qualityName(governor.quality)
+                  << " (frame cost " << governor.averageMs << " ms)"
+                  << std::endl;
+      }
 
       frameTime = SDL_GetTicks() - frameStart;
       if (frameDelay > frameTime) {
@@ -696,9 +1008,9 @@ public:
     SDL_Quit();
 
     std::cout << "\n=== FINAL STATS ===" << std::endl;
-    std::cout << "Score: " << score << std::endl;
+    std::cout << "Score: " << state.score << std::endl;
     std::cout << "High Score: " << highScore << std::endl;
-    std::cout << "Level Reached: " << level << std::endl;
+    std::cout << "Level Reached: " << state.level << std::endl;
     std::cout << "Thanks for playing! 🎮" << std::endl;
   }
 
@@ -706,7 +1018,27 @@ public:
 };
 
 int main(int argc, char *argv[]) {
-  Game game;
+  bool practice = false;
+  int quality = -1; // Adaptive unless pinned
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--practice") {
+      practice = true;
+    } else if (arg == "--quality=low") {
+      quality = QUALITY_LOW;
+    } else if (arg == "--quality=medium") {
+      quality = QUALITY_MEDIUM;
+    } else if (arg == "--quality=high") {
+      quality = QUALITY_HIGH;
+    } else {
+      std::cerr << "Unknown option: " << arg << std::endl;
+      std::cerr << "Usage: " << argv[0]
+                << " [--practice] [--quality=low|medium|high]" << std::endl;
+      return -1;
+    }
+  }
+
+  Game game(practice, quality);
 
   if (!game.init()) {
     std::cerr << "Failed to initialize game!" << std::endl;
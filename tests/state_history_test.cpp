@@ -0,0 +1,133 @@
+// Standalone check that StateHistory record/rewind round-trips exactly.
+// Build and run with: make test
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "game_state.h"
+
+static int failures = 0;
+
+// Ground truth: the state recorded at each tick of the current timeline
+static std::vector<GameState> truth;
+
+// Cheap game-like step: a few moving dots, periodic spawns, swap-removed
+// hits and the occasional pattern regeneration
+static void step(GameState &state) {
+  state.frameCount++;
+  state.rngState = state.rngState * 1664525u + 1013904223u;
+
+  for (int i = 0; i < state.dotCount; i++) {
+    state.dots[i].move();
+  }
+
+  if (state.frameCount % 40 == 0 && state.dotCount < 6) {
+    Color c = static_cast<Color>(state.rngState % 3);
+    state.dots[state.dotCount++] = Dot(225, -DOT_SIZE, c, 2.0f);
+  }
+
+  if (state.frameCount % 53 == 0 && state.dotCount > 0) {
+    state.dotCount--;
+    state.dots[0] = state.dots[state.dotCount];
+    state.score += 10;
+  }
+
+  if (state.frameCount % 301 == 0) {
+    state.patternLength = MAX_PATTERN_LENGTH;
+    for (int i = 0; i < MAX_PATTERN_LENGTH; i++) {
+      state.colorPattern[i] = static_cast<Color>(rand() % 3);
+    }
+  }
+}
+
+static void record(StateHistory &history, const GameState &state) {
+  history.record(state);
+  truth.resize(history.newestTick + 1);
+  truth[history.newestTick] = state;
+}
+
+static void expectSame(const GameState &got, int tick, const char *what) {
+  if (got.dotCount < 0 || got.dotCount > MAX_DOTS ||
+      memcmp(&got, &truth[tick], sizeof(GameState)) != 0) {
+    std::cerr << "FAIL " << what << ": tick " << tick << " differs"
+              << std::endl;
+    failures++;
+  }
+}
+
+// Restores every still-available tick from a copy, leaving `history` intact
+static void checkAllTicks(const StateHistory &history, const char *what) {
+  static StateHistory copy;
+  for (int t = history.oldestTick(); t <= history.newestTick; t++) {
+    copy = history;
+    GameState out;
+    int got = copy.rewindTo(t, out);
+    if (got != t) {
+      std::cerr << "FAIL " << what << ": asked for tick " << t << ", got "
+                << got << std::endl;
+      failures++;
+      continue;
+    }
+    expectSame(out, t, what);
+  }
+}
+
+static void reset(StateHistory &history, GameState &state) {
+  memset(&state, 0, sizeof(state));
+  state.level = 1;
+  state.rngState = 1;
+  history.clear();
+  truth.clear();
+}
+
+static StateHistory history;
+
+int main() {
+  GameState state;
+  srand(42);
+
+  // Straight recording well past the ring size
+  reset(history, state);
+  for (int t = 0; t < 3000; t++) {
+    step(state);
+    record(history, state);
+  }
+  checkAllTicks(history, "linear");
+
+  // Repeated 3 second rewinds with a single tick recorded in between, as
+  // when the player keeps pressing the wrong key in practice mode
+  for (int n = 0; n < 12 && !history.empty(); n++) {
+    int tick = history.rewindTo(history.newestTick - 180, state);
+    expectSame(state, tick, "repeated rewind");
+    step(state);
+    record(history, state);
+    checkAllTicks(history, "repeated rewind");
+  }
+
+  // Random mix of long runs and rewinds, long enough for the keyframe ring
+  // to wrap many times
+  reset(history, state);
+  for (int round = 0; round < 400; round++) {
+    int run = rand() % 400;
+    for (int t = 0; t < run; t++) {
+      step(state);
+      record(history, state);
+    }
+    if (history.empty())
+      continue;
+
+    int tick = history.rewindTo(history.newestTick - rand() % 800, state);
+    expectSame(state, tick, "random rewind");
+    if (round % 40 == 0)
+      checkAllTicks(history, "random rewind");
+  }
+
+  if (failures > 0) {
+    std::cerr << failures << " StateHistory check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "StateHistory round-trip checks passed" << std::endl;
+  return 0;
+}